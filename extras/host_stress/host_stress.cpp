@@ -0,0 +1,149 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Host stress test of the concurrent access: one writer registers Cards while
+// several readers check the Cards already registered, over a memory mapped
+// file (StorageFile) with LockStd. Build and run it with `make`, or with
+// `make SANITIZE=thread` to run it under ThreadSanitizer.
+
+// The standard headers come first, RFIDtoEEPROM.h may define min()
+#include <atomic>
+#include <stdio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <RFIDtoEEPROM.h>
+
+#define NUMBYTES 7
+#define READERS 4
+#define CARDS 200
+
+static const char *path = "host_stress.bin";
+
+// Card i of the test
+static void testCard(uint8_t i, byte *Code)
+{
+  for (uint8_t n = 0; n < NUMBYTES; n++)
+    Code[n] = (byte)(i * 31 + n * 7);
+}
+
+// Returns the number of errors seen with or without the RAM index, or while
+// the writer builds and drops it
+static int stress(bool index, bool toggle = false)
+{
+  StorageFile storage(path, 8192);
+  LockStd lock;
+
+  if (!storage.begin())
+  {
+    printf("Unable to open %s\n", path);
+    return (1);
+  }
+
+  Card card(storage, NUMBYTES);
+  card.EraseAllCards();
+  card.EnableFingerprint(2);
+
+  if (!card.beginLock(lock, index))
+  {
+    printf("beginLock failed\n");
+    return (1);
+  }
+
+  std::atomic<int> errors(0);
+  std::atomic<bool> done(false);
+
+  std::thread writer([&]() {
+    byte Code[NUMBYTES];
+
+    for (uint16_t i = 0; i < CARDS; i++)
+    {
+      testCard(i, Code);
+      if (!card.SaveCard(Code))
+        errors++;
+
+      if (toggle && (i % 20) == 0)
+        card.beginLock(lock, ((i / 20) % 2) != 0);
+    }
+
+    done = true;
+  });
+
+  std::vector<std::thread> readers;
+
+  for (uint8_t r = 0; r < READERS; r++)
+  {
+    readers.emplace_back([&]() {
+      byte Code[NUMBYTES];
+
+      while (!done)
+      {
+        // Every Card counted must be found
+        const uint8_t nbr = card.CardNumber();
+
+        for (uint8_t i = 0; i < nbr; i++)
+        {
+          testCard(i, Code);
+          if (!card.CardCheck(Code))
+            errors++;
+        }
+
+        // A Card not registered yet must not be found
+        testCard(CARDS, Code);
+        if (card.CardCheck(Code))
+          errors++;
+      }
+    });
+  }
+
+  writer.join();
+  for (std::thread &reader : readers)
+    reader.join();
+
+  if (card.CardNumber() != CARDS)
+    errors++;
+
+  // A new object must read the same Cards from the storage
+  Card check(storage, NUMBYTES);
+  byte Code[NUMBYTES];
+
+  check.EnableFingerprint(2);
+  for (uint16_t i = 0; i < CARDS; i++)
+  {
+    testCard(i, Code);
+    if (!check.CardCheck(Code))
+      errors++;
+  }
+
+  printf("%s index: %d error(s)\n", toggle ? "Toggled" : (index ? "RAM" : "No"), (int)errors);
+  return (errors);
+}
+
+int main()
+{
+  const int errors = stress(true) + stress(false) + stress(true, true);
+
+  unlink(path);
+  return (errors ? 1 : 0);
+}
@@ -22,20 +22,355 @@
 
 #include <RFIDtoEEPROM.h>
 
+// Fingerprint layout, stored after the Number of Cards: magic (2), fingerprint
+// size, maximum Number of Cards (the Code offset depends on it)
+#define LAYOUT_SIZE 4
+#define LAYOUT_MAGIC_0 0xF9
+#define LAYOUT_MAGIC_1 0x4C
+#define LAYOUT_INDEXED 0x80
+
+// Returns the size of the header (Number of Cards and layout if any)
+#define HEADER_SIZE (_fingerprintSize ? (1 + LAYOUT_SIZE) : 1)
+
 // Returns the address according to the Number of Cards
-#define OFFSET(a) ((a * _byteNumber) + 1)
+#define OFFSET(a) (((a) * _byteNumber) + HEADER_SIZE + (_maxCards * _fingerprintSize))
+
+// Returns the address of the fingerprint according to the Number of Cards
+#define FINGERPRINT(a) (((a) * _fingerprintSize) + HEADER_SIZE)
+
+// Persisted index header, stored right after the Cards (first 64 KB block):
+// magic (2), version, fingerprint size, Number of Cards, reserved, CRC16 (2)
+#define INDEX_HEADER OFFSET(_maxCards)
+#define INDEX_HEADER_SIZE 8
+#define INDEX_MAGIC_0 0x52
+#define INDEX_MAGIC_1 0x49
+#define INDEX_VERSION 1
 
 /**
  * @brief Construct a new Card:: Card object.
  *
+ * @param storage The storage driver holding the Cards.
  * @param byteNumber The number of bytes contained in the RFID Card.
- * @param eepromSize The EEPROM size in kbits.
  */
-Card::Card(uint8_t byteNumber, uint32_t eepromSize)
+Card::Card(Storage &storage, uint8_t byteNumber)
 {
+  _storage = &storage;
   _byteNumber = byteNumber;
-  eepromSize = eepromSize > 0 ? (eepromSize * 128) : Code::length();
-  _maxCards = min(((eepromSize - 1) / byteNumber), 255);
+  setMaxCards();
+}
+
+/**
+ * @brief Construct a new Card:: Card object whose storage driver is set by the
+ * derived class.
+ *
+ * @param byteNumber The number of bytes contained in the RFID Card.
+ */
+Card::Card(uint8_t byteNumber)
+{
+  _byteNumber = byteNumber;
+  _maxCards = 0;
+}
+
+/**
+ * @brief Destroy the Card:: Card object and free the RAM indexes.
+ *
+ */
+Card::~Card()
+{
+  free(_index);
+  free(_prints);
+}
+
+/**
+ * @brief Set the maximum Number of Cards according to the storage size.
+ *
+ */
+void Card::setMaxCards()
+{
+  const uint32_t eepromSize = Code::length();
+  const uint32_t reserved = _indexed ? (INDEX_HEADER_SIZE + HEADER_SIZE) : HEADER_SIZE;
+  const uint8_t recordSize = _byteNumber + _fingerprintSize;
+
+  _length = eepromSize;
+  _layoutChecked = false;
+  _maxCards = eepromSize > reserved ? min(((eepromSize - reserved) / recordSize), 255) : 0;
+}
+
+/**
+ * @brief Update the maximum Number of Cards if the storage size changed since
+ * (e.g. driver initialized after the constructor). The RAM indexes follow the
+ * new layout. The caller must hold the lock exclusively.
+ *
+ */
+void Card::updateMaxCards()
+{
+  if (Code::length() == _length)
+    return;
+
+  setMaxCards();
+
+  if (_prints != nullptr && !loadIndex())
+  {
+    free(_prints);
+    _prints = nullptr;
+    _printCount = 0;
+  }
+
+  if (_index != nullptr)
+    buildIndex();
+}
+
+/**
+ * @brief Set the retry policy of the EEPROM transfers. A stuck or noisy bus
+ * then gives a bounded latency, the error is returned by LastError().
+ *
+ * @param attempts Maximum attempts per transfer.
+ * @param backoff Delay before the first retry in µs, doubled at each retry.
+ * @param deadline Maximum duration of a transfer (at most CARD_BUFFER_SIZE
+ * bytes read or one page written) in ms.
+ */
+void Card::setRetryPolicy(uint8_t attempts, uint16_t backoff, uint16_t deadline)
+{
+  _storage->setRetryPolicy(attempts, backoff, deadline);
+}
+
+/**
+ * @brief Returns the EEPROM error of the last function accessing the EEPROM.
+ * A false result of CardCheck() or SaveCard() or a Number of Cards of 0 can
+ * be an error.
+ *
+ * @return storage_status_t STORAGE_OK if no error.
+ */
+storage_status_t Card::LastError()
+{
+  return _status;
+}
+
+/**
+ * @brief Store a short fingerprint of each Card in front of the Cards. A Card
+ * check then scans the fingerprints and only reads the full Code of the Cards
+ * whose fingerprint matches, which reduces the traffic for long UIDs.
+ *
+ * @param fingerprintSize The fingerprint size in bytes (1 to 4, 0 to disable).
+ * @return true The EEPROM uses this layout (or holds no Card).
+ * @return false Cards saved in another layout (or error), the fingerprint
+ * mode is unchanged.
+ *
+ * @warning The memory layout changes with the fingerprint size, the Cards
+ * already saved in another layout must be erased before. The RAM index of
+ * beginLock() is rebuilt. After beginIndex(), the same size keeps the
+ * persisted index and another size disables it.
+ */
+bool Card::EnableFingerprint(uint8_t fingerprintSize)
+{
+  LockGuard guard(_lock);
+  const bool oldIndexed = _indexed;
+  const uint8_t oldSize = _fingerprintSize;
+
+  fingerprintSize = min(fingerprintSize, 4);
+
+  // Already enabled by beginIndex()
+  if (_indexed && fingerprintSize == _fingerprintSize)
+    return (true);
+
+  _indexed = false;
+  _fingerprintSize = fingerprintSize;
+  setMaxCards();
+
+  if (!checkLayout())
+  {
+    _indexed = oldIndexed;
+    _fingerprintSize = oldSize;
+    setMaxCards();
+    return (false);
+  }
+
+  _layoutChecked = true;
+
+  // The persisted index was sized for the old fingerprints
+  free(_prints);
+  _prints = nullptr;
+  _printCount = 0;
+
+  // The Cards moved in the EEPROM
+  if (_index != nullptr)
+    buildIndex();
+
+  return (true);
+}
+
+/**
+ * @brief Write the fingerprint layout in the EEPROM.
+ *
+ * @return true Successful writing (or no fingerprint).
+ * @return false Error while writing.
+ */
+bool Card::writeLayout()
+{
+  if (!_fingerprintSize)
+    return (true);
+
+  const byte layout[LAYOUT_SIZE] = {LAYOUT_MAGIC_0, LAYOUT_MAGIC_1, (byte)(_fingerprintSize | (_indexed ? LAYOUT_INDEXED : 0)),
+                                    _maxCards};
+
+  return Code::write(1, layout, LAYOUT_SIZE);
+}
+
+/**
+ * @brief Check the layout of the Cards saved in the EEPROM (fingerprint size
+ * and maximum Number of Cards, which changes with the storage size) against
+ * the current layout. An EEPROM holding no Card takes the current layout.
+ *
+ * @return true Same layout (or no Card saved).
+ * @return false Cards saved in another layout (or error).
+ */
+bool Card::checkLayout()
+{
+  byte header[1 + LAYOUT_SIZE];
+
+  _status = STORAGE_OK;
+  if (!Code::read(0, header, sizeof(header)))
+    return (false);
+
+  const uint8_t printSize = header[3] & ~LAYOUT_INDEXED;
+  const bool printed = (header[1] == LAYOUT_MAGIC_0 && header[2] == LAYOUT_MAGIC_1 && printSize >= 1 && printSize <= 4);
+
+  if (_fingerprintSize)
+  {
+    if (printed && header[3] == (_fingerprintSize | (_indexed ? LAYOUT_INDEXED : 0)) && header[4] == _maxCards)
+      return (true);
+
+    if (header[0] == 0)
+      return writeLayout();
+  }
+  else if (header[0] == 0 || !printed)
+  {
+    return (true);
+  }
+
+  printDebug("Cards saved in another layout, erase them first!");
+  return (false);
+}
+
+/**
+ * @brief Check the layout once before the first access to the Cards (e.g. a
+ * Card object without fingerprint opening an EEPROM with fingerprints). The
+ * caller must hold the lock exclusively.
+ *
+ * @return true The Cards can be accessed.
+ * @return false Cards saved in another layout (or error).
+ */
+bool Card::layoutValid()
+{
+  if (!_layoutChecked)
+    _layoutChecked = checkLayout();
+
+  return (_layoutChecked);
+}
+
+/**
+ * @brief Compute the fingerprint (FNV-1a hash) of a Code.
+ *
+ * @param Code The UID of the RFID Code.
+ * @param print The fingerprint, _fingerprintSize bytes long.
+ */
+void Card::fingerprint(const byte *Code, byte *print)
+{
+  uint32_t hash = 2166136261UL;
+
+  for (uint8_t n = 0; n < _byteNumber; n++)
+  {
+    hash ^= Code[n];
+    hash *= 16777619UL;
+  }
+
+  for (uint8_t n = 0; n < _fingerprintSize; n++)
+  {
+    print[n] = (byte)(hash >> (n * 8));
+  }
+}
+
+/**
+ * @brief Search a fingerprint in the persisted index loaded in RAM if any,
+ * otherwise in the EEPROM.
+ *
+ * @param print The fingerprint to search.
+ * @param from Index of the first fingerprint to compare.
+ * @param nbr The number of Cards.
+ * @return int16_t Index of the matching fingerprint, -1 if none (or error).
+ */
+int16_t Card::searchPrint(const byte *print, uint8_t from, uint8_t nbr)
+{
+  if (_prints == nullptr)
+    return searchRecord(FINGERPRINT(0), _fingerprintSize, print, from, nbr);
+
+  for (uint16_t i = from; i < nbr; i++)
+  {
+    if (memcmp(print, (_prints + (i * _fingerprintSize)), _fingerprintSize) == 0)
+      return (i);
+  }
+
+  return (-1);
+}
+
+/**
+ * @brief Search a record among the records saved from a base address. The
+ * records are compared in place if the memory is mapped, otherwise several
+ * records are read per transfer.
+ *
+ * @param address Address of the first record.
+ * @param recordSize The record size.
+ * @param record The record to search.
+ * @param from Index of the first record to compare.
+ * @param nbr The number of records.
+ * @return int16_t Index of the matching record, -1 if none (or error).
+ */
+int16_t Card::searchRecord(uint32_t address, uint8_t recordSize, const byte *record, uint8_t from, uint8_t nbr)
+{
+  const uint8_t *mapped = _storage->data();
+
+  // Memory mapped in RAM: compare in place (never beyond the memory)
+  if (mapped != nullptr)
+  {
+    const uint32_t eepromSize = Code::length();
+
+    if (address > eepromSize)
+      return (-1);
+
+    nbr = min(nbr, ((eepromSize - address) / recordSize));
+
+    for (uint16_t i = from; i < nbr; i++)
+    {
+      if (memcmp(record, (mapped + address + (i * recordSize)), recordSize) == 0)
+        return (i);
+    }
+
+    return (-1);
+  }
+
+  // Otherwise read as many records as possible per transfer
+  uint16_t readSize = _storage->readSize();
+  if (!readSize || readSize > CARD_BUFFER_SIZE)
+    readSize = CARD_BUFFER_SIZE;
+
+  const uint8_t recordsPerRead = readSize >= recordSize ? (readSize / recordSize) : 1;
+  byte RecordRead[recordsPerRead * recordSize];
+
+  for (uint16_t i = from; i < nbr; i += recordsPerRead)
+  {
+    const uint8_t records = min(recordsPerRead, (nbr - i));
+
+    if (!Code::read((address + (i * recordSize)), RecordRead, (records * recordSize)))
+      return (-1);
+
+    for (uint8_t n = 0; n < records; n++)
+    {
+      if (memcmp(record, (RecordRead + (n * recordSize)), recordSize) == 0)
+        return (i + n);
+    }
+  }
+
+  return (-1);
 }
 
 /**
@@ -45,7 +380,28 @@ Card::Card(uint8_t byteNumber, uint32_t eepromSize)
  */
 uint8_t Card::CardNumber()
 {
-  return Code::read(0);
+  // The RAM index can change, it is only checked under the lock
+  {
+    LockGuard guard(_lock, true);
+
+    if (_index != nullptr)
+      return _indexCount;
+  }
+
+  LockGuard guard(_lock);
+
+  updateMaxCards();
+  if (_index != nullptr)
+    return _indexCount;
+
+  if (!layoutValid())
+    return (0);
+
+  _status = STORAGE_OK;
+  const uint8_t nbr = Code::read(0);
+
+  // An erased EEPROM reads 0xFF
+  return min(nbr, _maxCards);
 }
 
 /**
@@ -55,6 +411,9 @@ uint8_t Card::CardNumber()
  */
 uint8_t Card::MaxCards()
 {
+  LockGuard guard(_lock);
+
+  updateMaxCards();
   return _maxCards;
 }
 
@@ -64,23 +423,50 @@ uint8_t Card::MaxCards()
  */
 void Card::ClearCardNumber()
 {
-  Code::write(0, 0);
+  LockGuard guard(_lock);
+
+  _status = STORAGE_OK;
+  if (Code::write(0, 0))
+  {
+    _indexCount = 0;
+    _printCount = 0;
+    writeIndexHeader();
+  }
 }
 
 /**
- * @brief Erase all Cards.
+ * @brief Erase all Cards: the region used by the Cards (and the index header)
+ * is reset to 0, the rest of the EEPROM is left untouched.
  *
  * @note The EEPROM memory has a specified life of 100,000 write/erase cycles,
  * so you may need to be careful about how often you write to it.
  */
 void Card::EraseAllCards()
 {
-  byte Code[_pageSize] = {};
+  LockGuard guard(_lock);
+
+  updateMaxCards();
+  const uint32_t used = _indexed ? (INDEX_HEADER + INDEX_HEADER_SIZE) : OFFSET(_maxCards);
+  const uint32_t eepromSize = min(used, Code::length());
+  uint16_t pageSize = _storage->pageSize();
+
+  if (!pageSize || pageSize > CARD_BUFFER_SIZE)
+    pageSize = CARD_BUFFER_SIZE;
 
-  for (uint32_t n = 0; n < (Code::length() / _pageSize); n++)
+  byte Code[pageSize];
+  memset(Code, 0, pageSize);
+
+  _status = STORAGE_OK;
+  for (uint32_t address = 0; address < eepromSize; address += pageSize)
   {
-    Code::write((n * _pageSize), Code, _pageSize);
+    if (!Code::write(address, Code, min(pageSize, (eepromSize - address))))
+      return;
   }
+
+  _indexCount = 0;
+  _printCount = 0;
+  _layoutChecked = writeLayout();
+  writeIndexHeader();
 }
 
 /**
@@ -113,11 +499,21 @@ bool Card::WriteCheck(byte *Code, uint8_t nbr)
   if (Code::read(0) != (nbr + 1))
     return (false);
 
-  Code::read(OFFSET(nbr), CodeRead, _byteNumber);
-  for (uint8_t n = 0; n < _byteNumber; n++)
+  if (!Code::read(OFFSET(nbr), CodeRead, _byteNumber))
+    return (false);
+
+  if (memcmp(Code, CodeRead, _byteNumber) != 0)
+    return (false);
+
+  if (_fingerprintSize)
   {
-    if (Code[n] != CodeRead[n])
+    byte print[4];
+
+    fingerprint(Code, print);
+    if (!Code::read(FINGERPRINT(nbr), CodeRead, _fingerprintSize))
       return (false);
+
+    return (memcmp(print, CodeRead, _fingerprintSize) == 0);
   }
 
   return (true);
@@ -133,8 +529,6 @@ bool Card::WriteCheck(byte *Code, uint8_t nbr)
  */
 bool Card::SaveCard(uint8_t *Code, uint8_t size)
 {
-  const uint8_t nbr = CardNumber();
-
   // if size different from Constructor!
   if ((size != _byteNumber))
   {
@@ -142,6 +536,19 @@ bool Card::SaveCard(uint8_t *Code, uint8_t size)
     return (NULL);
   }
 
+  LockGuard guard(_lock);
+  uint8_t nbr;
+
+  updateMaxCards();
+  if (!layoutValid())
+    return (false);
+
+  _status = STORAGE_OK;
+  if (!Code::read(0, &nbr, 1))
+    return (false);
+
+  nbr = min(nbr, _maxCards);
+
   // if Number of Cards over limit!
   if (nbr >= _maxCards)
   {
@@ -150,11 +557,19 @@ bool Card::SaveCard(uint8_t *Code, uint8_t size)
   }
 
   // if Card already saved!
-  if (CardCheck(Code, size))
+  if (searchCard(Code))
     return (true);
 
   Code::write(OFFSET(nbr), Code, _byteNumber);
 
+  if (_fingerprintSize)
+  {
+    byte print[4];
+
+    fingerprint(Code, print);
+    Code::write(FINGERPRINT(nbr), print, _fingerprintSize);
+  }
+
   Code::write(0, (nbr + 1));
 
   if (!WriteCheck(Code, nbr))
@@ -164,6 +579,19 @@ bool Card::SaveCard(uint8_t *Code, uint8_t size)
     return (false);
   }
 
+  if (_index != nullptr)
+  {
+    memcpy((_index + (nbr * _byteNumber)), Code, _byteNumber);
+    _indexCount = nbr + 1;
+  }
+
+  if (_prints != nullptr)
+  {
+    fingerprint(Code, (_prints + (nbr * _fingerprintSize)));
+    _printCount = nbr + 1;
+    writeIndexHeader();
+  }
+
   return (true);
 }
 
@@ -177,9 +605,6 @@ bool Card::SaveCard(uint8_t *Code, uint8_t size)
  */
 bool Card::CardCheck(uint8_t *Code, uint8_t size)
 {
-  const uint8_t nbr = CardNumber();
-  byte CodeRead[_byteNumber];
-
   // if size different from Constructor!
   if ((size != _byteNumber))
   {
@@ -187,22 +612,288 @@ bool Card::CardCheck(uint8_t *Code, uint8_t size)
     return (NULL);
   }
 
-  for (uint8_t i = 0; i < nbr; i++)
+  // Lookups in the RAM index can run in parallel, the EEPROM access is
+  // exclusive. The RAM index can change, it is only checked under the lock.
   {
-    uint8_t match = 0;
+    LockGuard guard(_lock, true);
+
+    if (_index != nullptr)
+      return searchCard(Code);
+  }
+
+  LockGuard guard(_lock);
 
-    Code::read(OFFSET(i), CodeRead, _byteNumber);
-    for (uint8_t n = 0; n < _byteNumber; n++)
+  updateMaxCards();
+  if (!layoutValid())
+    return (false);
+
+  return searchCard(Code);
+}
+
+/**
+ * @brief Search the Card in the RAM index if any, otherwise in the EEPROM.
+ * The caller must hold the lock.
+ *
+ * @param Code The UID of the RFID Code to search.
+ * @return true The Card is saved.
+ * @return false The Card is not saved!
+ */
+bool Card::searchCard(const byte *Code)
+{
+  if (_index != nullptr)
+  {
+    for (uint8_t i = 0; i < _indexCount; i++)
     {
-      if (Code[n] == CodeRead[n])
-        match++;
+      if (memcmp(Code, (_index + (i * _byteNumber)), _byteNumber) == 0)
+        return (true);
     }
 
-    if (match == _byteNumber)
-    {
+    return (false);
+  }
+
+  uint8_t nbr = _printCount;
+
+  _status = STORAGE_OK;
+  if (_prints == nullptr && !Code::read(0, &nbr, 1))
+    return (false);
+
+  // An erased EEPROM reads 0xFF
+  nbr = min(nbr, _maxCards);
+
+  if (!_fingerprintSize)
+    return (searchRecord(OFFSET(0), _byteNumber, Code, 0, nbr) >= 0);
+
+  // Scan the fingerprints, then confirm with the full Code
+  byte print[4];
+  byte CodeRead[_byteNumber];
+
+  fingerprint(Code, print);
+  for (int16_t i = searchPrint(print, 0, nbr); i >= 0; i = searchPrint(print, (i + 1), nbr))
+  {
+    if (!Code::read(OFFSET(i), CodeRead, _byteNumber))
+      return (false);
+
+    if (memcmp(Code, CodeRead, _byteNumber) == 0)
       return (true);
-    }
   }
 
   return (false);
 }
+
+/**
+ * @brief Enable concurrent access (e.g. Card checks and registrations from
+ * several tasks). Each access to the EEPROM is exclusive. With the RAM index,
+ * the Cards are copied in RAM so that Card checks run in parallel without
+ * accessing the EEPROM.
+ *
+ * @param lock The lock to use. Share it between the objects using the same bus.
+ * @param index True to build the RAM index (_maxCards * byteNumber bytes).
+ * @return true Successful initialization.
+ * @return false Error while building the index.
+ *
+ * @note Call it after the EEPROM initialization, before the other tasks use
+ * the object. It can then be called again to build or drop the RAM index.
+ * EnableFingerprint() and beginIndex() change the memory layout, they rebuild
+ * the RAM index.
+ */
+bool Card::beginLock(Lock &lock, bool index)
+{
+  // Only set by the first call, before the other tasks use the object
+  if (_lock != &lock)
+    _lock = &lock;
+
+  LockGuard guard(_lock);
+
+  updateMaxCards();
+  if (!index)
+  {
+    free(_index);
+    _index = nullptr;
+    _indexCount = 0;
+    return (true);
+  }
+
+  return buildIndex();
+}
+
+/**
+ * @brief Copy the Cards in the RAM index according to the current layout.
+ * On failure, the RAM index is dropped and the Card checks read the EEPROM.
+ * The caller must hold the lock.
+ *
+ * @return true Successful copy.
+ * @return false Error while building the index.
+ */
+bool Card::buildIndex()
+{
+  free(_index);
+  _indexCount = 0;
+
+  _index = (byte *)malloc(_maxCards * _byteNumber);
+  if (_index == nullptr)
+  {
+    printDebug("Not enough memory for the index!");
+    return (false);
+  }
+
+  uint8_t nbr;
+
+  _status = STORAGE_OK;
+  if (!layoutValid() || !Code::read(0, &nbr, 1) || !Code::read(OFFSET(0), _index, (min(nbr, _maxCards) * _byteNumber)))
+  {
+    free(_index);
+    _index = nullptr;
+    return (false);
+  }
+
+  _indexCount = min(nbr, _maxCards);
+  return (true);
+}
+
+/**
+ * @brief Enable the persisted index: the fingerprint mode plus a header after
+ * the Cards holding a checksum of the fingerprints. The index is validated
+ * and loaded in RAM with a few bulk reads, so that the Card checks do not
+ * scan the EEPROM. It is rebuilt from the Cards if invalid (e.g. reset
+ * during a registration) and then updated by each registration.
+ *
+ * @param fingerprintSize The fingerprint size in bytes (1 to 4).
+ * @return true Index loaded (or rebuilt).
+ * @return false Error while loading the index, the Card checks then read
+ * the fingerprints from the EEPROM.
+ *
+ * @warning The memory layout changes, the Cards already saved in another
+ * layout must be erased before. Call it after the EEPROM initialization.
+ */
+bool Card::beginIndex(uint8_t fingerprintSize)
+{
+  LockGuard guard(_lock);
+  const bool oldIndexed = _indexed;
+  const uint8_t oldSize = _fingerprintSize;
+
+  _indexed = true;
+  _fingerprintSize = constrain(fingerprintSize, 1, 4);
+  setMaxCards();
+
+  if (!checkLayout())
+  {
+    _indexed = oldIndexed;
+    _fingerprintSize = oldSize;
+    setMaxCards();
+    return (false);
+  }
+
+  _layoutChecked = true;
+
+  const bool loaded = loadIndex();
+
+  // Never keep a partial index
+  if (!loaded)
+  {
+    free(_prints);
+    _prints = nullptr;
+    _printCount = 0;
+  }
+
+  // The Cards moved in the EEPROM
+  if (_index != nullptr)
+    buildIndex();
+
+  return (loaded);
+}
+
+/**
+ * @brief Load the persisted index in RAM, or rebuild it from the Cards if
+ * invalid. The caller frees the index on failure.
+ *
+ * @return true Index loaded (or rebuilt).
+ * @return false Error while loading the index.
+ */
+bool Card::loadIndex()
+{
+  free(_prints);
+  _prints = (byte *)malloc(_maxCards * _fingerprintSize);
+  _printCount = 0;
+  if (_prints == nullptr)
+  {
+    printDebug("Not enough memory for the index!");
+    return (false);
+  }
+
+  byte header[INDEX_HEADER_SIZE];
+  uint8_t nbr;
+
+  _status = STORAGE_OK;
+  if (!layoutValid() || !Code::read(0, &nbr, 1) || !Code::read(INDEX_HEADER, header, INDEX_HEADER_SIZE))
+    return (false);
+
+  nbr = min(nbr, _maxCards);
+
+  if (header[0] == INDEX_MAGIC_0 && header[1] == INDEX_MAGIC_1 && header[2] == INDEX_VERSION &&
+      header[3] == _fingerprintSize && header[4] == nbr &&
+      Code::read(FINGERPRINT(0), _prints, (nbr * _fingerprintSize)))
+  {
+    _printCount = nbr;
+    if (indexChecksum() == (uint16_t)(header[6] | (header[7] << 8)))
+      return (true);
+  }
+
+  // Rebuild the index from the Cards
+  printDebug("Rebuilding the index...");
+
+  byte CodeRead[_byteNumber];
+
+  for (uint8_t i = 0; i < nbr; i++)
+  {
+    if (!Code::read(OFFSET(i), CodeRead, _byteNumber))
+      return (false);
+
+    fingerprint(CodeRead, (_prints + (i * _fingerprintSize)));
+  }
+
+  _printCount = nbr;
+  if (!Code::write(FINGERPRINT(0), _prints, (nbr * _fingerprintSize)))
+    return (false);
+
+  return writeIndexHeader();
+}
+
+/**
+ * @brief Compute the checksum (CRC16-CCITT) of the index header and of the
+ * fingerprints loaded in RAM.
+ *
+ * @return uint16_t The checksum.
+ */
+uint16_t Card::indexChecksum()
+{
+  const byte header[] = {INDEX_MAGIC_0, INDEX_MAGIC_1, INDEX_VERSION, _fingerprintSize, _printCount, 0};
+  uint16_t crc = 0xFFFF;
+
+  for (uint16_t n = 0; n < (sizeof(header) + (_printCount * _fingerprintSize)); n++)
+  {
+    crc ^= (uint16_t)(n < sizeof(header) ? header[n] : _prints[n - sizeof(header)]) << 8;
+
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+  }
+
+  return (crc);
+}
+
+/**
+ * @brief Write the index header according to the fingerprints loaded in RAM.
+ *
+ * @return true Successful writing (or no persisted index).
+ * @return false Error while writing.
+ */
+bool Card::writeIndexHeader()
+{
+  if (_prints == nullptr)
+    return (true);
+
+  const uint16_t crc = indexChecksum();
+  const byte header[INDEX_HEADER_SIZE] = {INDEX_MAGIC_0, INDEX_MAGIC_1, INDEX_VERSION, _fingerprintSize, _printCount, 0,
+                                          (byte)(crc & 0xFF), (byte)(crc >> 8)};
+
+  return Code::write(INDEX_HEADER, header, INDEX_HEADER_SIZE);
+}
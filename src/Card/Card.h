@@ -24,11 +24,17 @@
 #define Card_h
 
 #include <Code.h>
+#include <Lock.h>
 
 class Card : public Code
 {
   public:
-    Card(uint8_t byteNumber = 4, uint32_t eepromSize = 0);
+    Card(Storage &storage, uint8_t byteNumber = 4);
+    ~Card();
+
+    // The RAM indexes are owned by the object
+    Card(const Card &) = delete;
+    Card &operator=(const Card &) = delete;
 
     template <typename T>
     bool CardCheck(T &t)
@@ -44,20 +50,51 @@ class Card : public Code
       return SaveCard(Code, sizeof(T));
     }
 
+    bool beginLock(Lock &lock, bool index = true);
+    bool beginIndex(uint8_t fingerprintSize = 2);
+    bool EnableFingerprint(uint8_t fingerprintSize = 2);
     void ClearCardNumber(void);
     void EraseAllCards(void);
     uint8_t CardNumber(void);
     uint8_t MaxCards(void);
+    storage_status_t LastError(void);
+    void setRetryPolicy(uint8_t attempts, uint16_t backoff, uint16_t deadline);
 
   private:
     bool CardCheck(byte *Code, uint8_t size);
     bool SaveCard(byte *Code, uint8_t size);
     bool WriteCheck(byte *Code, uint8_t nbr);
     void CardRestoration(uint8_t nbr);
+    bool searchCard(const byte *Code);
+    bool writeLayout(void);
+    bool checkLayout(void);
+    bool layoutValid(void);
+    void fingerprint(const byte *Code, byte *print);
+    int16_t searchPrint(const byte *print, uint8_t from, uint8_t nbr);
+    bool buildIndex(void);
+    bool loadIndex(void);
+    uint16_t indexChecksum(void);
+    bool writeIndexHeader(void);
+    int16_t searchRecord(uint32_t address, uint8_t recordSize, const byte *record, uint8_t from, uint8_t nbr);
 
   protected:
+    Card(uint8_t byteNumber);
+    void setMaxCards(void);
+    void updateMaxCards(void);
+
     uint8_t _byteNumber;
     uint8_t _maxCards;
+    uint32_t _length = 0;
+    bool _layoutChecked = false;
+    uint8_t _fingerprintSize = 0;
+
+    Lock *_lock = nullptr;
+    byte *_index = nullptr;
+    uint8_t _indexCount = 0;
+
+    bool _indexed = false;
+    byte *_prints = nullptr;
+    uint8_t _printCount = 0;
 };
 
 #endif // _Card_h
@@ -20,120 +20,114 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #include <RFIDtoEEPROM.h>
-#include <EEPROM.h>
 
 /**
- * @brief Read Code from EEPROM.
+ * @brief Read Code from EEPROM in transfers of CARD_BUFFER_SIZE bytes, so
+ * that the deadline of each transfer holds for large reads. On error, the
+ * Code is zeroed and the status is kept in _status.
  *
  * @param address Departure address for reading.
  * @param Code Variable that will be modified by reading.
  * @param byteNumber The Number of byte to read.
+ * @return true Successful reading.
+ * @return false Error while reading.
  */
-void Code::read(uint32_t address, byte *Code, uint8_t byteNumber)
+bool Code::read(uint32_t address, byte *Code, uint16_t byteNumber)
 {
-  if (_local)
+  for (uint16_t n = 0; n < byteNumber; n += CARD_BUFFER_SIZE)
   {
-    for (uint8_t n = 0; n < byteNumber; n++)
-    {
-      Code[n] = EEPROM.read(address + n);
-    }
-  }
-  else
-  {
-    uint8_t rxStatus = 0;
+    const storage_status_t status = _storage->read((address + n), (Code + n), min((byteNumber - n), CARD_BUFFER_SIZE));
 
-    while (byteNumber > 0)
+    if (status != STORAGE_OK)
     {
-      uint8_t bytePage = _pageSize - (address & (_pageSize - 1));
-      uint8_t byteRead = min((min(bytePage, byteNumber)), (BUFFER_LENGTH - 2));
-
-      while (isBusy())
-        delayMicroseconds(100);
-
-      Wire.beginTransmission((uint8_t)_eepromAddr);
-      if (_twoAddress)
-        Wire.write((uint8_t)(address >> 8)); // MSB
-      Wire.write((uint8_t)(address & 0xFF)); // LSB
-      rxStatus = Wire.endTransmission();
-      if (rxStatus != 0)
-      {
-        printDebug(("Error: " + String(rxStatus) + " during reading!"));
-        return; // Read error
-      }
-
-      Wire.requestFrom((uint8_t)_eepromAddr, (uint8_t)byteRead);
-
-      uint8_t i = 0;
-      while (Wire.available())
-      {
-        Code[i++] = Wire.read();
-      }
-
-      address += byteRead;    // Increment the EEPROM address
-      Code += byteRead;       // Increment the input data pointer
-      byteNumber -= byteRead; // Decrement the number of bytes left to read
+      _status = status;
+      memset(Code, 0, byteNumber);
+      printDebug(("Error: " + String(status) + " during reading!"));
+      return (false);
     }
   }
+
+  return (true);
 }
 
 /**
- * @brief Write Code to EEPROM.
+ * @brief Write Code to EEPROM. Each page is compared with the Code first and
+ * only the changed span is written, which avoids write cycles when the data
+ * is already there (e.g. erasing an empty EEPROM).
  *
  * @param address Departure address for writing.
  * @param Code Code to write.
  * @param byteNumber The Number of byte to write.
+ * @return true Successful writing.
+ * @return false Error while writing.
  */
-void Code::write(uint32_t address, byte *Code, uint8_t byteNumber)
+bool Code::write(uint32_t address, const byte *Code, uint16_t byteNumber)
 {
-  if (_local)
+  // Without write cycle, comparing costs more than writing
+  if (!_storage->writeCycle())
+    return writeStorage(address, Code, byteNumber);
+
+  const uint8_t *mapped = _storage->data();
+  uint16_t pageSize = _storage->pageSize();
+
+  if (!pageSize || pageSize > CARD_BUFFER_SIZE)
+    pageSize = CARD_BUFFER_SIZE;
+
+  byte CodeRead[pageSize];
+
+  while (byteNumber > 0)
   {
-    for (uint8_t n = 0; n < byteNumber; n++)
-    {
-#if defined(ESP8266) || defined(ESP32)
-      EEPROM.write((address + n), Code[n]);
-#else
-      EEPROM.update((address + n), Code[n]);
-#endif
-    }
-#if defined(ESP8266) || defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
-    if (!EEPROM.commit())
+    uint16_t bytePage = pageSize - (address % pageSize);
+    uint16_t byteWrite = min(bytePage, byteNumber);
+    const byte *current = (mapped != nullptr) ? (mapped + address) : CodeRead;
+    uint16_t first = 0;
+    uint16_t last = byteWrite;
+
+    // Unreadable page: write it entirely
+    if (mapped != nullptr || _storage->read(address, CodeRead, byteWrite) == STORAGE_OK)
     {
-      printDebug("ERROR: EEPROM commit failed!");
+      while (first < byteWrite && current[first] == Code[first])
+        first++;
+
+      while (last > first && current[last - 1] == Code[last - 1])
+        last--;
     }
-#endif
+
+    if (first < last && !writeStorage((address + first), (Code + first), (last - first)))
+      return (false);
+
+    address += byteWrite;    // Increment the EEPROM address
+    Code += byteWrite;       // Increment the input data pointer
+    byteNumber -= byteWrite; // Decrement the number of bytes left to write
   }
-  else
-  {
-    uint8_t txStatus = 0;
 
-    while (byteNumber > 0)
-    {
-      uint8_t bytePage = _pageSize - (address & (_pageSize - 1));
-      uint8_t byteWrite = min((min(bytePage, byteNumber)), (BUFFER_LENGTH - 2));
-
-      while (isBusy())
-        delayMicroseconds(100);
-
-      Wire.beginTransmission((uint8_t)_eepromAddr);
-      if (_twoAddress)
-        Wire.write((uint8_t)(address >> 8)); // MSB
-      Wire.write((uint8_t)(address & 0xFF)); // LSB
-      Wire.write(Code, (uint8_t)byteWrite);
-      txStatus = Wire.endTransmission();
-      if (txStatus != 0)
-      {
-        printDebug(("Error: " + String(txStatus) + " during writing!"));
-        return; // Write error
-      }
-
-      address += byteWrite;    // Increment the EEPROM address
-      Code += byteWrite;       // Increment the input data pointer
-      byteNumber -= byteWrite; // Decrement the number of bytes left to write
-
-      delayMicroseconds(500);
-    }
+  return (true);
+}
+
+/**
+ * @brief Write Code to EEPROM without comparison. On error, the status is kept
+ * in _status.
+ *
+ * @param address Departure address for writing.
+ * @param Code Code to write.
+ * @param byteNumber The Number of byte to write.
+ * @return true Successful writing.
+ * @return false Error while writing.
+ */
+bool Code::writeStorage(uint32_t address, const byte *Code, uint16_t byteNumber)
+{
+  const storage_status_t status = _storage->write(address, Code, byteNumber);
+
+  if (status != STORAGE_OK)
+  {
+    _status = status;
+    printDebug(("Error: " + String(status) + " during writing!"));
+    return (false);
   }
+
+  return (true);
 }
 
 /**
@@ -143,10 +137,7 @@ void Code::write(uint32_t address, byte *Code, uint8_t byteNumber)
  */
 uint32_t Code::length()
 {
-  if (_local)
-    return EEPROM.length();
-
-  return (_eepromSize * 128);
+  return _storage->length();
 }
 
 /**
@@ -157,55 +148,21 @@ uint32_t Code::length()
  */
 uint8_t Code::read(uint32_t address)
 {
-  uint8_t data;
+  uint8_t data = 0;
 
   read(address, &data, 1);
   return (data);
 }
 
 /**
- * @brief Write byte to EEPROM.
+ * @brief Write byte to EEPROM (skipped if unchanged).
  *
  * @param address Address for writing.
  * @param data The byte to write.
+ * @return true Successful writing.
+ * @return false Error while writing.
  */
-void Code::write(uint32_t address, uint8_t data)
-{
-  if (read(address) != data)
-    write(address, &data, 1);
-}
-
-/**
- * @brief Check if device is not answering (currently writing).
- *
- * @return true Busy.
- * @return false Ready for reading/writing.
- */
-bool Code::isBusy()
-{
-  Wire.beginTransmission((uint8_t)_eepromAddr);
-  if (!Wire.endTransmission())
-    return (false);
-
-  return (true);
-}
-
-/**
- * @brief Returns the page size of EEPROM.
- *
- * @param eepromSize EEPROM size in Kbits.
- * @return uint8_t The page size of EEPROM.
- */
-uint8_t Code::pageSize(uint32_t eepromSize)
+bool Code::write(uint32_t address, uint8_t data)
 {
-  if (eepromSize < KBITS_4)
-    return 8;
-  else if (eepromSize < KBITS_32)
-    return 16;
-  else if (eepromSize < KBITS_128)
-    return 32;
-  else if (eepromSize < KBITS_512)
-    return 64;
-
-  return 128;
+  return write(address, &data, 1);
 }
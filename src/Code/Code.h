@@ -20,30 +20,41 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #ifndef Code_h
 #define Code_h
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+#include <Host.h>
+#endif
+#include <Storage.h>
 #include <StreamDebug.h>
 
+// Size of the buffers used to read or write several Cards at once.
+#ifndef CARD_BUFFER_SIZE
+#if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)
+#define CARD_BUFFER_SIZE 128
+#else
+#define CARD_BUFFER_SIZE 32
+#endif
+#endif
+
 class Code : public StreamDebug
 {
   protected:
-    void read(uint32_t address, byte *Code, uint8_t byteNumber);
+    bool read(uint32_t address, byte *Code, uint16_t byteNumber);
     uint8_t read(uint32_t address);
-    void write(uint32_t address, byte *Code, uint8_t byteNumber);
-    void write(uint32_t address, uint8_t data);
-    uint8_t pageSize(uint32_t eepromSize);
+    bool write(uint32_t address, const byte *Code, uint16_t byteNumber);
+    bool write(uint32_t address, uint8_t data);
     uint32_t length(void);
 
-    bool _local;
-    bool _twoAddress;
-    uint8_t _eepromAddr;
-    uint8_t _pageSize = 8;
-    uint32_t _eepromSize;
+    Storage *_storage = nullptr;
+    storage_status_t _status = STORAGE_OK;
 
   private:
-    bool isBusy(void);
+    bool writeStorage(uint32_t address, const byte *Code, uint16_t byteNumber);
 };
 
 #endif // _Code_h
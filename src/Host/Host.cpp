@@ -0,0 +1,84 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <Host.h>
+
+#if !defined(ARDUINO)
+
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief Print a message followed by a new line.
+ *
+ * @param msg The message to print.
+ * @return size_t The number of characters printed.
+ */
+size_t Stream::println(const String &msg)
+{
+  const int written = fprintf(_file, "%s\n", msg.c_str());
+
+  return (written > 0 ? written : 0);
+}
+
+/**
+ * @brief Returns the number of milliseconds since an arbitrary origin.
+ *
+ * @return unsigned long Milliseconds.
+ */
+unsigned long millis()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Returns the number of microseconds since an arbitrary origin.
+ *
+ * @return unsigned long Microseconds.
+ */
+unsigned long micros()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Pause the current thread.
+ *
+ * @param ms Duration in milliseconds.
+ */
+void delay(unsigned long ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief Pause the current thread.
+ *
+ * @param us Duration in microseconds.
+ */
+void delayMicroseconds(unsigned int us)
+{
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+#endif // !ARDUINO
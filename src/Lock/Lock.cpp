@@ -0,0 +1,59 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+/**
+ * @brief Construct a new LockGuard::LockGuard object and take the lock.
+ *
+ * @param lock The lock to take, nothing is done if nullptr.
+ * @param shared True for a shared access, false for an exclusive access.
+ */
+LockGuard::LockGuard(Lock *lock, bool shared)
+{
+  _lock = lock;
+  _shared = shared;
+
+  if (_lock == nullptr)
+    return;
+
+  if (_shared)
+    _lock->lockShared();
+  else
+    _lock->lock();
+}
+
+/**
+ * @brief Destroy the LockGuard::LockGuard object and release the lock.
+ *
+ */
+LockGuard::~LockGuard()
+{
+  if (_lock == nullptr)
+    return;
+
+  if (_shared)
+    _lock->unlockShared();
+  else
+    _lock->unlock();
+}
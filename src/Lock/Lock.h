@@ -0,0 +1,135 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef Lock_h
+#define Lock_h
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <Host.h>
+#endif
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#elif defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)
+#include <pico/mutex.h>
+#include <pico/sem.h>
+#elif !defined(ARDUINO)
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Reader-writer lock used by Card for concurrent access. A waiting writer blocks
+// the new readers, so Card checks in a loop cannot starve a registration.
+class Lock
+{
+  public:
+    virtual ~Lock() {}
+
+    // Shared access: lookups in the RAM index.
+    virtual void lockShared(void) = 0;
+    virtual void unlockShared(void) = 0;
+    // Exclusive access: bus access and writes.
+    virtual void lock(void) = 0;
+    virtual void unlock(void) = 0;
+};
+
+// Takes the lock (if any) for the current scope.
+class LockGuard
+{
+  public:
+    LockGuard(Lock *lock, bool shared = false);
+    ~LockGuard();
+
+  private:
+    Lock *_lock;
+    bool _shared;
+};
+
+#if defined(ESP32)
+
+// Reader-writer lock built on FreeRTOS semaphores.
+class LockFreeRTOS : public Lock
+{
+  public:
+    LockFreeRTOS(void);
+
+    void lockShared(void) override;
+    void unlockShared(void) override;
+    void lock(void) override;
+    void unlock(void) override;
+
+  private:
+    StaticSemaphore_t _turnstileBuffer;
+    StaticSemaphore_t _readersBuffer;
+    StaticSemaphore_t _writerBuffer;
+    SemaphoreHandle_t _turnstile;
+    SemaphoreHandle_t _readersMutex;
+    SemaphoreHandle_t _writer;
+    uint16_t _readers = 0;
+};
+
+#elif defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)
+
+// Reader-writer lock built on the Pico SDK primitives (safe between both cores).
+class LockPico : public Lock
+{
+  public:
+    LockPico(void);
+
+    void lockShared(void) override;
+    void unlockShared(void) override;
+    void lock(void) override;
+    void unlock(void) override;
+
+  private:
+    mutex_t _turnstile;
+    mutex_t _readersMutex;
+    semaphore_t _writer;
+    uint16_t _readers = 0;
+};
+
+#elif !defined(ARDUINO)
+
+// Reader-writer lock built on the standard library, for host builds.
+class LockStd : public Lock
+{
+  public:
+    void lockShared(void) override;
+    void unlockShared(void) override;
+    void lock(void) override;
+    void unlock(void) override;
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    uint16_t _readers = 0;
+    uint16_t _writersWaiting = 0;
+    bool _writer = false;
+};
+
+#endif
+
+#endif // _Lock_h
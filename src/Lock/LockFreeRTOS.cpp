@@ -0,0 +1,89 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if defined(ESP32)
+
+/**
+ * @brief Construct a new LockFreeRTOS::LockFreeRTOS object.
+ *
+ */
+LockFreeRTOS::LockFreeRTOS()
+{
+  _turnstile = xSemaphoreCreateMutexStatic(&_turnstileBuffer);
+  _readersMutex = xSemaphoreCreateMutexStatic(&_readersBuffer);
+  // Binary semaphore: the last reader may release it from another task
+  _writer = xSemaphoreCreateBinaryStatic(&_writerBuffer);
+  xSemaphoreGive(_writer);
+}
+
+/**
+ * @brief Take a shared access. The first reader blocks the writers.
+ *
+ */
+void LockFreeRTOS::lockShared()
+{
+  // Wait behind a writer already waiting
+  xSemaphoreTake(_turnstile, portMAX_DELAY);
+  xSemaphoreGive(_turnstile);
+
+  xSemaphoreTake(_readersMutex, portMAX_DELAY);
+  if (++_readers == 1)
+    xSemaphoreTake(_writer, portMAX_DELAY);
+  xSemaphoreGive(_readersMutex);
+}
+
+/**
+ * @brief Release a shared access. The last reader unblocks the writers.
+ *
+ */
+void LockFreeRTOS::unlockShared()
+{
+  xSemaphoreTake(_readersMutex, portMAX_DELAY);
+  if (--_readers == 0)
+    xSemaphoreGive(_writer);
+  xSemaphoreGive(_readersMutex);
+}
+
+/**
+ * @brief Take an exclusive access.
+ *
+ */
+void LockFreeRTOS::lock()
+{
+  xSemaphoreTake(_turnstile, portMAX_DELAY);
+  xSemaphoreTake(_writer, portMAX_DELAY);
+}
+
+/**
+ * @brief Release an exclusive access.
+ *
+ */
+void LockFreeRTOS::unlock()
+{
+  xSemaphoreGive(_turnstile);
+  xSemaphoreGive(_writer);
+}
+
+#endif // ESP32
@@ -0,0 +1,88 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if defined(ARDUINO_ARCH_RP2040) && !defined(ARDUINO_ARCH_MBED)
+
+/**
+ * @brief Construct a new LockPico::LockPico object.
+ *
+ */
+LockPico::LockPico()
+{
+  mutex_init(&_turnstile);
+  mutex_init(&_readersMutex);
+  // Semaphore: the last reader may release it from the other core
+  sem_init(&_writer, 1, 1);
+}
+
+/**
+ * @brief Take a shared access. The first reader blocks the writers.
+ *
+ */
+void LockPico::lockShared()
+{
+  // Wait behind a writer already waiting
+  mutex_enter_blocking(&_turnstile);
+  mutex_exit(&_turnstile);
+
+  mutex_enter_blocking(&_readersMutex);
+  if (++_readers == 1)
+    sem_acquire_blocking(&_writer);
+  mutex_exit(&_readersMutex);
+}
+
+/**
+ * @brief Release a shared access. The last reader unblocks the writers.
+ *
+ */
+void LockPico::unlockShared()
+{
+  mutex_enter_blocking(&_readersMutex);
+  if (--_readers == 0)
+    sem_release(&_writer);
+  mutex_exit(&_readersMutex);
+}
+
+/**
+ * @brief Take an exclusive access.
+ *
+ */
+void LockPico::lock()
+{
+  mutex_enter_blocking(&_turnstile);
+  sem_acquire_blocking(&_writer);
+}
+
+/**
+ * @brief Release an exclusive access.
+ *
+ */
+void LockPico::unlock()
+{
+  mutex_exit(&_turnstile);
+  sem_release(&_writer);
+}
+
+#endif // ARDUINO_ARCH_RP2040 && !ARDUINO_ARCH_MBED
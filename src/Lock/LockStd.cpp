@@ -0,0 +1,78 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if !defined(ARDUINO)
+
+/**
+ * @brief Take a shared access, waits while a writer holds or waits for the lock.
+ *
+ */
+void LockStd::lockShared()
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+
+  _cond.wait(guard, [this] { return !_writer && _writersWaiting == 0; });
+  _readers++;
+}
+
+/**
+ * @brief Release a shared access.
+ *
+ */
+void LockStd::unlockShared()
+{
+  std::lock_guard<std::mutex> guard(_mutex);
+
+  if (--_readers == 0)
+    _cond.notify_all();
+}
+
+/**
+ * @brief Take an exclusive access, waits until there is no reader or writer.
+ *
+ */
+void LockStd::lock()
+{
+  std::unique_lock<std::mutex> guard(_mutex);
+
+  _writersWaiting++;
+  _cond.wait(guard, [this] { return !_writer && _readers == 0; });
+  _writersWaiting--;
+  _writer = true;
+}
+
+/**
+ * @brief Release an exclusive access.
+ *
+ */
+void LockStd::unlock()
+{
+  std::lock_guard<std::mutex> guard(_mutex);
+
+  _writer = false;
+  _cond.notify_all();
+}
+
+#endif // !ARDUINO
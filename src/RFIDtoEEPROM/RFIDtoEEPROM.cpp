@@ -22,6 +22,8 @@
 
 #include <RFIDtoEEPROM.h>
 
+#if defined(ARDUINO)
+
 /**
  * @brief Construct a new RFIDtoEEPROM::RFIDtoEEPROM object
  *
@@ -29,13 +31,12 @@
  */
 RFIDtoEEPROM::RFIDtoEEPROM(uint8_t byteNumber) : Card(byteNumber)
 {
-  _local = true;
+  _storage = &_eeprom;
+  setMaxCards();
 }
 
 #if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)
 
-#include <EEPROM.h>
-
 /**
  * @brief Set the EEPROM emulation size.
  *
@@ -43,8 +44,10 @@ RFIDtoEEPROM::RFIDtoEEPROM(uint8_t byteNumber) : Card(byteNumber)
  */
 void RFIDtoEEPROM::begin(uint32_t eepromSize)
 {
-  EEPROM.begin(eepromSize);
-  _maxCards = min(((EEPROM.length() - 1) / _byteNumber), 255);
+  _eeprom.begin(eepromSize);
+  setMaxCards();
 }
 
 #endif // ESP32 || ESP8266 || ARDUINO_ARCH_RP2040
+
+#endif // ARDUINO
@@ -24,40 +24,22 @@
 #define RFIDtoEEPROM_h
 
 #include <Card.h>
-#include <Wire.h>
 
 #ifndef min
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
-#ifndef BUFFER_LENGTH
-#define BUFFER_LENGTH 32
-#endif
-
-//EEPROM size in Kbits.
-enum eeprom_size_t
-{
-  KBITS_1 = 1,
-  KBITS_2 = 2,
-  KBITS_4 = 4,
-  KBITS_8 = 8,
-  KBITS_16 = 16,
-  KBITS_32 = 32,
-  KBITS_64 = 64,
-  KBITS_128 = 128,
-  KBITS_256 = 256,
-  KBITS_512 = 512,
-  KBITS_1024 = 1024,
-  KBITS_2048 = 2048
-};
-
 // I2C Clock Frequencies.
 enum twiClockFreq_t
 {
+  TWICLOCKAUTO = 0, // Fastest clock giving error-free transfers
   TWICLOCK100KHZ = 100000,
-  TWICLOCK400KHZ = 400000
+  TWICLOCK400KHZ = 400000,
+  TWICLOCK1MHZ = 1000000 // Fast Mode Plus
 };
 
+#if defined(ARDUINO)
+
 class RFIDtoEEPROM : public Card
 {
   public:
@@ -66,6 +48,9 @@ class RFIDtoEEPROM : public Card
 #if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)
     void begin(uint32_t eepromSize);
 #endif
+
+  private:
+    StorageEEPROM _eeprom;
 };
 
 class RFIDtoEEPROM_I2C : public Card
@@ -73,7 +58,24 @@ class RFIDtoEEPROM_I2C : public Card
   public:
     RFIDtoEEPROM_I2C(eeprom_size_t eepromSize = KBITS_256, uint8_t address = 0x50, uint8_t byteNumber = 4);
 
-    void begin(twiClockFreq_t twiFreq = TWICLOCK100KHZ);
+    void begin(twiClockFreq_t twiFreq = TWICLOCK100KHZ, twiClockFreq_t maxFreq = TWICLOCK1MHZ);
+    uint32_t twiClock(void);
+
+  private:
+    StorageI2C _eeprom;
 };
 
+class RFIDtoEEPROM_SPI : public Card
+{
+  public:
+    RFIDtoEEPROM_SPI(eeprom_size_t eepromSize, uint8_t csPin, bool fram = false, uint8_t byteNumber = 4);
+
+    void begin(uint32_t spiFreq = 4000000);
+
+  private:
+    StorageSPI _eeprom;
+};
+
+#endif // ARDUINO
+
 #endif // _RFIDtoEEPROM_h
@@ -22,6 +22,8 @@
 
 #include <RFIDtoEEPROM.h>
 
+#if defined(ARDUINO)
+
 /**
  * @brief Construct a new RFIDtoEEPROM_I2C::RFIDtoEEPROM_I2C object.
  *
@@ -29,26 +31,35 @@
  * @param address I2C address of EEPROM.
  * @param byteNumber The number of bytes contained in the RFID Card.
  */
-RFIDtoEEPROM_I2C::RFIDtoEEPROM_I2C(eeprom_size_t eepromSize, uint8_t address, uint8_t byteNumber) : Card(byteNumber, eepromSize)
+RFIDtoEEPROM_I2C::RFIDtoEEPROM_I2C(eeprom_size_t eepromSize, uint8_t address, uint8_t byteNumber) : Card(byteNumber), _eeprom(eepromSize, address)
 {
-  _local = false;
-  _eepromAddr = address;
-  _eepromSize = eepromSize;
-  _pageSize = pageSize(eepromSize);
-  _twoAddress = eepromSize > KBITS_16 ? true : false;
+  _storage = &_eeprom;
+  setMaxCards();
 }
 
 /**
- * @brief Set the I2C communication frequency.
+ * @brief Set the I2C communication frequency. With TWICLOCKAUTO, the fastest
+ * frequency giving error-free transfers is negotiated with the EEPROM.
  *
  * @param twiFreq I2C Frequency.
+ * @param maxFreq Highest frequency tried with TWICLOCKAUTO.
+ *
+ * @note The frequency applies to the whole I2C bus, including the other
+ * devices on it.
  */
-void RFIDtoEEPROM_I2C::begin(twiClockFreq_t twiFreq)
+void RFIDtoEEPROM_I2C::begin(twiClockFreq_t twiFreq, twiClockFreq_t maxFreq)
 {
-  Wire.begin();
-  Wire.setClock(twiFreq);
-  Wire.beginTransmission(_eepromAddr);
-  if (_twoAddress) Wire.write(0);
-  Wire.write(0);
-  Wire.endTransmission();
+  _eeprom.begin(twiFreq, maxFreq);
 }
+
+/**
+ * @brief Returns the I2C communication frequency in use.
+ *
+ * @return uint32_t I2C Frequency.
+ */
+uint32_t RFIDtoEEPROM_I2C::twiClock()
+{
+  return _eeprom.clock();
+}
+
+#endif // ARDUINO
@@ -0,0 +1,51 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <RFIDtoEEPROM.h>
+
+#if defined(ARDUINO)
+
+/**
+ * @brief Construct a new RFIDtoEEPROM_SPI::RFIDtoEEPROM_SPI object.
+ *
+ * @param eepromSize EEPROM size in kbits.
+ * @param csPin Chip select pin of EEPROM.
+ * @param fram True for a FRAM (FM25 series).
+ * @param byteNumber The number of bytes contained in the RFID Card.
+ */
+RFIDtoEEPROM_SPI::RFIDtoEEPROM_SPI(eeprom_size_t eepromSize, uint8_t csPin, bool fram, uint8_t byteNumber) : Card(byteNumber), _eeprom(eepromSize, csPin, fram)
+{
+  _storage = &_eeprom;
+  setMaxCards();
+}
+
+/**
+ * @brief Set the SPI communication frequency.
+ *
+ * @param spiFreq SPI Frequency.
+ */
+void RFIDtoEEPROM_SPI::begin(uint32_t spiFreq)
+{
+  _eeprom.begin(spiFreq);
+}
+
+#endif // ARDUINO
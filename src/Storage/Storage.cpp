@@ -0,0 +1,103 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+/**
+ * @brief Returns the page size of EEPROM.
+ *
+ * @param eepromSize EEPROM size in Kbits.
+ * @return uint8_t The page size of EEPROM.
+ */
+uint8_t eepromPageSize(eeprom_size_t eepromSize)
+{
+  if (eepromSize < KBITS_4)
+    return 8;
+  else if (eepromSize < KBITS_32)
+    return 16;
+  else if (eepromSize < KBITS_128)
+    return 32;
+  else if (eepromSize < KBITS_512)
+    return 64;
+
+  return 128;
+}
+
+/**
+ * @brief Set the retry policy of the transfers (a read or a write call). The
+ * worst-case duration of a transfer is bounded by the deadline, retries and
+ * write cycles included, instead of hanging on a stuck bus.
+ *
+ * @param attempts Maximum attempts per transfer (at least 1).
+ * @param backoff Delay before the first retry in µs, doubled at each retry.
+ * @param deadline Maximum duration of a transfer in ms.
+ */
+void Storage::setRetryPolicy(uint8_t attempts, uint16_t backoff, uint16_t deadline)
+{
+  _retry.attempts = attempts > 0 ? attempts : 1;
+  _retry.backoff = backoff;
+  _retry.deadline = deadline;
+}
+
+/**
+ * @brief Wait until the device is ready (end of the write cycle).
+ *
+ * @param start Start time of the transfer in ms.
+ * @return storage_status_t STORAGE_OK if ready, STORAGE_TIMEOUT at the deadline.
+ */
+storage_status_t Storage::waitReady(unsigned long start)
+{
+  while (isBusy())
+  {
+    if ((millis() - start) >= _retry.deadline)
+      return (STORAGE_TIMEOUT);
+
+    delayMicroseconds(100);
+  }
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Check if a failed transfer can be attempted again and wait the
+ * backoff delay (never beyond the deadline).
+ *
+ * @param attempt Index of the failed attempt (0 for the first one).
+ * @param start Start time of the transfer in ms.
+ * @return true Try again.
+ * @return false Give up.
+ */
+bool Storage::retry(uint8_t attempt, unsigned long start)
+{
+  const unsigned long elapsed = millis() - start;
+
+  if ((attempt + 1) >= _retry.attempts || elapsed >= _retry.deadline)
+    return (false);
+
+  uint32_t wait = (uint32_t)_retry.backoff << min(attempt, 15);
+  wait = min(wait, ((_retry.deadline - elapsed) * 1000UL));
+
+  delay(wait / 1000);
+  delayMicroseconds(wait % 1000);
+  return (true);
+}
@@ -0,0 +1,214 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef Storage_h
+#define Storage_h
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+#else
+#include <Host.h>
+#endif
+
+//EEPROM size in Kbits.
+enum eeprom_size_t
+{
+  KBITS_1 = 1,
+  KBITS_2 = 2,
+  KBITS_4 = 4,
+  KBITS_8 = 8,
+  KBITS_16 = 16,
+  KBITS_32 = 32,
+  KBITS_64 = 64,
+  KBITS_128 = 128,
+  KBITS_256 = 256,
+  KBITS_512 = 512,
+  KBITS_1024 = 1024,
+  KBITS_2048 = 2048
+};
+
+// Status of a storage access.
+enum storage_status_t
+{
+  STORAGE_OK = 0,
+  STORAGE_NACK,       // Device not acknowledging
+  STORAGE_SHORT_READ, // Fewer bytes received than requested
+  STORAGE_TIMEOUT,    // Device still busy (or bus stuck) at the deadline
+  STORAGE_ERROR       // Other error (bus, commit, out of range)
+};
+
+// Retry policy of a transfer.
+struct storage_retry_t
+{
+  uint8_t attempts;  // Maximum attempts per transfer
+  uint16_t backoff;  // Delay before the first retry in µs, doubled at each retry
+  uint16_t deadline; // Maximum duration of a transfer (retries and busy wait included) in ms
+};
+
+uint8_t eepromPageSize(eeprom_size_t eepromSize);
+
+// Storage driver used by Code to access the memory.
+class Storage
+{
+  public:
+    virtual ~Storage() {}
+
+    virtual storage_status_t read(uint32_t address, uint8_t *data, uint16_t length) = 0;
+    virtual storage_status_t write(uint32_t address, const uint8_t *data, uint16_t length) = 0;
+    virtual uint32_t length(void) = 0;
+
+    // Write page size in bytes (0 if writes are not page bound).
+    virtual uint16_t pageSize(void) { return 0; }
+    // Maximum number of bytes per read transfer (0 if unlimited).
+    virtual uint16_t readSize(void) { return 0; }
+    // True if a write starts an internal write cycle (polled with isBusy).
+    virtual bool writeCycle(void) { return false; }
+    virtual bool isBusy(void) { return false; }
+    // Pointer to the memory content if it is mapped in RAM.
+    virtual const uint8_t *data(void) { return nullptr; }
+
+    void setRetryPolicy(uint8_t attempts, uint16_t backoff, uint16_t deadline);
+
+  protected:
+    storage_status_t waitReady(unsigned long start);
+    bool retry(uint8_t attempt, unsigned long start);
+
+    storage_retry_t _retry = {3, 500, 20};
+};
+
+#if defined(ARDUINO)
+
+// Internal (or emulated) EEPROM.
+class StorageEEPROM : public Storage
+{
+  public:
+#if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)
+    void begin(uint32_t eepromSize);
+#endif
+
+    storage_status_t read(uint32_t address, uint8_t *data, uint16_t length) override;
+    storage_status_t write(uint32_t address, const uint8_t *data, uint16_t length) override;
+    uint32_t length(void) override;
+    bool writeCycle(void) override { return true; }
+    const uint8_t *data(void) override;
+};
+
+// I2C EEPROM (24xx series).
+class StorageI2C : public Storage
+{
+  public:
+    StorageI2C(eeprom_size_t eepromSize = KBITS_256, uint8_t address = 0x50, TwoWire &wire = Wire);
+
+    void begin(uint32_t twiFreq, uint32_t maxFreq = 1000000);
+    uint32_t clock(void);
+
+    storage_status_t read(uint32_t address, uint8_t *data, uint16_t length) override;
+    storage_status_t write(uint32_t address, const uint8_t *data, uint16_t length) override;
+    uint32_t length(void) override;
+    uint16_t pageSize(void) override { return _pageSize; }
+    uint16_t readSize(void) override { return BUFFER_LENGTH; }
+    bool writeCycle(void) override { return true; }
+    bool isBusy(void) override;
+
+  private:
+    storage_status_t readBlock(uint32_t address, uint8_t *data, uint8_t length);
+    storage_status_t writeBlock(uint32_t address, const uint8_t *data, uint8_t length);
+    storage_status_t status(uint8_t twiStatus);
+    uint8_t deviceAddress(uint32_t address);
+    uint32_t blockSize(void);
+    void negotiateClock(void);
+    void transferStatus(storage_status_t status);
+
+    TwoWire *_wire;
+    bool _autoClock = false;
+    uint8_t _errors = 0;
+    uint32_t _clock = 100000;
+    uint32_t _maxClock = 1000000;
+    bool _twoAddress;
+    uint8_t _eepromAddr;
+    uint8_t _pageSize;
+    uint32_t _eepromSize;
+};
+
+// SPI EEPROM (25xx series) or FRAM (FM25 series).
+class StorageSPI : public Storage
+{
+  public:
+    StorageSPI(eeprom_size_t eepromSize, uint8_t csPin, bool fram = false, SPIClass &spi = SPI);
+
+    void begin(uint32_t spiFreq);
+
+    storage_status_t read(uint32_t address, uint8_t *data, uint16_t length) override;
+    storage_status_t write(uint32_t address, const uint8_t *data, uint16_t length) override;
+    uint32_t length(void) override;
+    uint16_t pageSize(void) override { return _fram ? 0 : _pageSize; }
+    bool writeCycle(void) override { return !_fram; }
+    bool isBusy(void) override;
+
+  private:
+    void command(uint8_t opcode, uint32_t address);
+
+    SPIClass *_spi;
+    SPISettings _settings;
+    bool _fram;
+    uint8_t _csPin;
+    uint8_t _addressBytes;
+    uint8_t _pageSize;
+    uint32_t _eepromSize;
+};
+
+#endif // ARDUINO
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+
+// File mapped in memory, for host builds.
+class StorageFile : public Storage
+{
+  public:
+    StorageFile(const char *path, uint32_t size);
+    ~StorageFile();
+
+    bool begin(void);
+    void end(void);
+
+    storage_status_t read(uint32_t address, uint8_t *data, uint16_t length) override;
+    storage_status_t write(uint32_t address, const uint8_t *data, uint16_t length) override;
+    uint32_t length(void) override { return _size; }
+    const uint8_t *data(void) override { return _map; }
+
+  private:
+    const char *_path;
+    int _fd = -1;
+    uint8_t *_map = nullptr;
+    uint32_t _size;
+};
+
+#endif // !ARDUINO && (__unix__ || __APPLE__)
+
+#endif // _Storage_h
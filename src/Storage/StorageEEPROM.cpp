@@ -0,0 +1,114 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if defined(ARDUINO)
+
+#include <EEPROM.h>
+
+#if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040)
+
+/**
+ * @brief Set the EEPROM emulation size.
+ *
+ * @param eepromSize The EEPROM size in Byte!!!
+ */
+void StorageEEPROM::begin(uint32_t eepromSize)
+{
+  EEPROM.begin(eepromSize);
+}
+
+#endif // ESP32 || ESP8266 || ARDUINO_ARCH_RP2040
+
+/**
+ * @brief Read data from internal EEPROM.
+ *
+ * @param address Departure address for reading.
+ * @param data Buffer that will be modified by reading.
+ * @param length The Number of byte to read.
+ * @return storage_status_t STORAGE_OK or the error.
+ */
+storage_status_t StorageEEPROM::read(uint32_t address, uint8_t *data, uint16_t length)
+{
+  for (uint16_t n = 0; n < length; n++)
+  {
+    data[n] = EEPROM.read(address + n);
+  }
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Write data to internal EEPROM.
+ *
+ * @param address Departure address for writing.
+ * @param data Data to write.
+ * @param length The Number of byte to write.
+ * @return storage_status_t STORAGE_OK or the error.
+ */
+storage_status_t StorageEEPROM::write(uint32_t address, const uint8_t *data, uint16_t length)
+{
+  for (uint16_t n = 0; n < length; n++)
+  {
+#if defined(ESP8266) || defined(ESP32)
+    EEPROM.write((address + n), data[n]);
+#else
+    EEPROM.update((address + n), data[n]);
+#endif
+  }
+
+#if defined(ESP8266) || defined(ESP32) || defined(ARDUINO_ARCH_RP2040)
+  return (EEPROM.commit() ? STORAGE_OK : STORAGE_ERROR);
+#else
+  return (STORAGE_OK);
+#endif
+}
+
+/**
+ * @brief Returns the Number of Cells in the EEPROM.
+ *
+ * @return uint32_t The Number of Cells in the EEPROM.
+ */
+uint32_t StorageEEPROM::length()
+{
+  return EEPROM.length();
+}
+
+/**
+ * @brief Returns the RAM copy of the emulated EEPROM. Only the const getter
+ * is used: getDataPtr() marks the EEPROM as modified, so each commit would
+ * rewrite the flash (ESP32 has no const getter).
+ *
+ * @return const uint8_t* The EEPROM content, nullptr if not mapped.
+ */
+const uint8_t *StorageEEPROM::data()
+{
+#if defined(ESP8266)
+  return EEPROM.getConstDataPtr();
+#else
+  return nullptr;
+#endif
+}
+
+#endif // ARDUINO
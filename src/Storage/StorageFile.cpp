@@ -0,0 +1,139 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief Construct a new StorageFile::StorageFile object.
+ *
+ * @param path Path of the file holding the memory content.
+ * @param size The memory size in Byte.
+ */
+StorageFile::StorageFile(const char *path, uint32_t size)
+{
+  _path = path;
+  _size = size;
+}
+
+/**
+ * @brief Destroy the StorageFile::StorageFile object.
+ *
+ */
+StorageFile::~StorageFile()
+{
+  end();
+}
+
+/**
+ * @brief Open (or create) the file and map it in memory.
+ *
+ * @return true Successful mapping.
+ * @return false Error while opening or mapping.
+ */
+bool StorageFile::begin()
+{
+  end();
+
+  _fd = open(_path, O_RDWR | O_CREAT, 0644);
+  if (_fd < 0)
+    return (false);
+
+  if (ftruncate(_fd, _size) != 0)
+  {
+    end();
+    return (false);
+  }
+
+  void *map = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if (map == MAP_FAILED)
+  {
+    end();
+    return (false);
+  }
+
+  _map = (uint8_t *)map;
+  return (true);
+}
+
+/**
+ * @brief Flush the content to the file and release it.
+ *
+ */
+void StorageFile::end()
+{
+  if (_map != nullptr)
+  {
+    msync(_map, _size, MS_SYNC);
+    munmap(_map, _size);
+    _map = nullptr;
+  }
+
+  if (_fd >= 0)
+  {
+    close(_fd);
+    _fd = -1;
+  }
+}
+
+/**
+ * @brief Read data from the file.
+ *
+ * @param address Departure address for reading.
+ * @param data Buffer that will be modified by reading.
+ * @param length The Number of byte to read.
+ * @return storage_status_t STORAGE_OK or the error.
+ */
+storage_status_t StorageFile::read(uint32_t address, uint8_t *data, uint16_t length)
+{
+  if (_map == nullptr || (address + length) > _size)
+    return (STORAGE_ERROR);
+
+  memcpy(data, _map + address, length);
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Write data to the file.
+ *
+ * @param address Departure address for writing.
+ * @param data Data to write.
+ * @param length The Number of byte to write.
+ * @return storage_status_t STORAGE_OK or the error.
+ */
+storage_status_t StorageFile::write(uint32_t address, const uint8_t *data, uint16_t length)
+{
+  if (_map == nullptr || (address + length) > _size)
+    return (STORAGE_ERROR);
+
+  memcpy(_map + address, data, length);
+  return (STORAGE_OK);
+}
+
+#endif // !ARDUINO && (__unix__ || __APPLE__)
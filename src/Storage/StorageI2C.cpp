@@ -0,0 +1,367 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if defined(ARDUINO)
+
+// Clocks tried by the negotiation, slowest first
+static const uint32_t twiClocks[] = {100000, 400000, 1000000};
+#define TWI_CLOCKS (sizeof(twiClocks) / sizeof(twiClocks[0]))
+
+// Number of test reads per clock during the negotiation
+#define TWI_PROBES 4
+
+// Error count (decreased by each successful transfer) lowering the clock
+#define TWI_ERROR_LIMIT 8
+
+/**
+ * @brief Construct a new StorageI2C::StorageI2C object.
+ *
+ * @param eepromSize EEPROM size in kbits.
+ * @param address I2C address of EEPROM.
+ * @param wire The I2C bus used by the EEPROM.
+ */
+StorageI2C::StorageI2C(eeprom_size_t eepromSize, uint8_t address, TwoWire &wire)
+{
+  _wire = &wire;
+  _eepromAddr = address;
+  _eepromSize = eepromSize;
+  _pageSize = eepromPageSize(eepromSize);
+  _twoAddress = eepromSize > KBITS_16 ? true : false;
+}
+
+/**
+ * @brief Set the I2C communication frequency.
+ *
+ * @param twiFreq I2C Frequency, 0 to negotiate the fastest one.
+ * @param maxFreq Highest frequency tried by the negotiation.
+ *
+ * @note The frequency applies to the whole bus: other devices on it (or
+ * another EEPROM negotiating its own frequency) are affected, so limit
+ * maxFreq to the slowest device of the bus.
+ */
+void StorageI2C::begin(uint32_t twiFreq, uint32_t maxFreq)
+{
+  _autoClock = (twiFreq == 0);
+  _maxClock = maxFreq;
+  _clock = _autoClock ? twiClocks[0] : twiFreq;
+  _errors = 0;
+
+  _wire->begin();
+  _wire->setClock(_clock);
+#if defined(WIRE_HAS_TIMEOUT)
+  // Do not hang on a stuck bus (AVR)
+  _wire->setWireTimeout(25000, true);
+#endif
+  _wire->beginTransmission(_eepromAddr);
+  if (_twoAddress) _wire->write(0);
+  _wire->write(0);
+  _wire->endTransmission();
+
+  if (_autoClock)
+    negotiateClock();
+}
+
+/**
+ * @brief Returns the I2C communication frequency in use.
+ *
+ * @return uint32_t I2C Frequency.
+ */
+uint32_t StorageI2C::clock()
+{
+  return _clock;
+}
+
+/**
+ * @brief Select the fastest clock giving error-free transfers. The beginning
+ * of the EEPROM is read at the slowest clock as reference, then read again at
+ * increasing clocks (up to the maximum clock) until a transfer fails or
+ * differs.
+ *
+ */
+void StorageI2C::negotiateClock()
+{
+  const uint8_t probeSize = min((uint32_t)BUFFER_LENGTH, length());
+  uint8_t reference[probeSize];
+  uint8_t probe[probeSize];
+
+  if (read(0, reference, probeSize) != STORAGE_OK)
+    return; // Keep the slowest clock
+
+  for (uint8_t i = 1; i < TWI_CLOCKS && twiClocks[i] <= _maxClock; i++)
+  {
+    _wire->setClock(twiClocks[i]);
+
+    for (uint8_t n = 0; n < TWI_PROBES; n++)
+    {
+      // No retry: a single error rejects the clock
+      if (waitReady(millis()) != STORAGE_OK || readBlock(0, probe, probeSize) != STORAGE_OK ||
+          memcmp(reference, probe, probeSize) != 0)
+      {
+        _wire->setClock(_clock);
+        return;
+      }
+    }
+
+    _clock = twiClocks[i];
+  }
+}
+
+/**
+ * @brief Count the transfer errors. With a negotiated clock, the clock is
+ * lowered when the errors rise.
+ *
+ * @param status The transfer status.
+ */
+void StorageI2C::transferStatus(storage_status_t status)
+{
+  if (status == STORAGE_OK)
+  {
+    if (_errors > 0)
+      _errors--;
+    return;
+  }
+
+  if (!_autoClock || ++_errors < TWI_ERROR_LIMIT)
+    return;
+
+  _errors = 0;
+  for (uint8_t i = TWI_CLOCKS - 1; i > 0; i--)
+  {
+    if (twiClocks[i] == _clock)
+    {
+      _clock = twiClocks[i - 1];
+      _wire->setClock(_clock);
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Read data from I2C EEPROM. Each block is retried according to the
+ * retry policy, within the deadline of the whole transfer.
+ *
+ * @param address Departure address for reading.
+ * @param data Buffer that will be modified by reading.
+ * @param length The Number of byte to read.
+ * @return storage_status_t STORAGE_OK or the error of the failed transfer.
+ */
+storage_status_t StorageI2C::read(uint32_t address, uint8_t *data, uint16_t length)
+{
+  const unsigned long start = millis();
+
+  while (length > 0)
+  {
+    // Sequential reads are only bound by the block selected in the device address
+    uint32_t byteBlock = blockSize() - (address & (blockSize() - 1));
+    uint8_t byteRead = min((min(byteBlock, (uint32_t)length)), (uint32_t)BUFFER_LENGTH);
+    storage_status_t status;
+
+    for (uint8_t attempt = 0;; attempt++)
+    {
+      status = waitReady(start);
+      if (status == STORAGE_OK)
+        status = readBlock(address, data, byteRead);
+      transferStatus(status);
+
+      if (status == STORAGE_OK || !retry(attempt, start))
+        break;
+    }
+
+    if (status != STORAGE_OK)
+      return (status);
+
+    address += byteRead; // Increment the EEPROM address
+    data += byteRead;    // Increment the input data pointer
+    length -= byteRead;  // Decrement the number of bytes left to read
+  }
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Write data to I2C EEPROM. Each block is retried according to the
+ * retry policy, within the deadline of the whole transfer.
+ *
+ * @param address Departure address for writing.
+ * @param data Data to write.
+ * @param length The Number of byte to write.
+ * @return storage_status_t STORAGE_OK or the error of the failed transfer.
+ */
+storage_status_t StorageI2C::write(uint32_t address, const uint8_t *data, uint16_t length)
+{
+  const unsigned long start = millis();
+
+  while (length > 0)
+  {
+    uint16_t bytePage = _pageSize - (address & (_pageSize - 1));
+    uint8_t byteWrite = min((min(bytePage, length)), (BUFFER_LENGTH - 2));
+    storage_status_t status;
+
+    for (uint8_t attempt = 0;; attempt++)
+    {
+      status = waitReady(start);
+      if (status == STORAGE_OK)
+        status = writeBlock(address, data, byteWrite);
+      transferStatus(status);
+
+      if (status == STORAGE_OK || !retry(attempt, start))
+        break;
+    }
+
+    if (status != STORAGE_OK)
+      return (status);
+
+    address += byteWrite; // Increment the EEPROM address
+    data += byteWrite;    // Increment the input data pointer
+    length -= byteWrite;  // Decrement the number of bytes left to write
+
+    delayMicroseconds(500);
+  }
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Read a block in one transfer.
+ *
+ * @param address Departure address for reading.
+ * @param data Buffer that will be modified by reading.
+ * @param length The Number of byte to read.
+ * @return storage_status_t The transfer status.
+ */
+storage_status_t StorageI2C::readBlock(uint32_t address, uint8_t *data, uint8_t length)
+{
+  _wire->beginTransmission(deviceAddress(address));
+  if (_twoAddress)
+    _wire->write((uint8_t)(address >> 8)); // MSB
+  _wire->write((uint8_t)(address & 0xFF)); // LSB
+  storage_status_t rxStatus = status(_wire->endTransmission());
+  if (rxStatus != STORAGE_OK)
+    return (rxStatus);
+
+  if (_wire->requestFrom(deviceAddress(address), length) != length)
+    return (STORAGE_SHORT_READ);
+
+  for (uint8_t i = 0; i < length; i++)
+  {
+    data[i] = _wire->read();
+  }
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Write a block (within a page) in one transfer.
+ *
+ * @param address Departure address for writing.
+ * @param data Data to write.
+ * @param length The Number of byte to write.
+ * @return storage_status_t The transfer status.
+ */
+storage_status_t StorageI2C::writeBlock(uint32_t address, const uint8_t *data, uint8_t length)
+{
+  _wire->beginTransmission(deviceAddress(address));
+  if (_twoAddress)
+    _wire->write((uint8_t)(address >> 8)); // MSB
+  _wire->write((uint8_t)(address & 0xFF)); // LSB
+  _wire->write(data, length);
+
+  return status(_wire->endTransmission());
+}
+
+/**
+ * @brief Convert the status returned by endTransmission().
+ *
+ * @param twiStatus The Wire status.
+ * @return storage_status_t The storage status.
+ */
+storage_status_t StorageI2C::status(uint8_t twiStatus)
+{
+  switch (twiStatus)
+  {
+    case 0:
+      return (STORAGE_OK);
+    case 2: // NACK on address
+    case 3: // NACK on data
+      return (STORAGE_NACK);
+    case 5:
+      return (STORAGE_TIMEOUT);
+    default:
+      return (STORAGE_ERROR);
+  }
+}
+
+/**
+ * @brief Returns the Number of Cells in the EEPROM.
+ *
+ * @return uint32_t The Number of Cells in the EEPROM.
+ */
+uint32_t StorageI2C::length()
+{
+  return (_eepromSize * 128);
+}
+
+/**
+ * @brief Check if device is not answering (currently writing).
+ *
+ * @return true Busy.
+ * @return false Ready for reading/writing.
+ */
+bool StorageI2C::isBusy()
+{
+  _wire->beginTransmission(_eepromAddr);
+  if (!_wire->endTransmission())
+    return (false);
+
+  return (true);
+}
+
+/**
+ * @brief Returns the device address selecting the block of the given address.
+ * Small EEPROMs (1 address byte) and large ones (beyond 64 KB) carry the upper
+ * address bits in the device address.
+ *
+ * @param address Memory address.
+ * @return uint8_t The I2C device address.
+ */
+uint8_t StorageI2C::deviceAddress(uint32_t address)
+{
+  if (_twoAddress)
+    return (_eepromAddr | ((address >> 16) & 0x03));
+
+  return (_eepromAddr | ((address >> 8) & 0x07));
+}
+
+/**
+ * @brief Returns the size of the block addressed by one device address.
+ *
+ * @return uint32_t The block size in bytes.
+ */
+uint32_t StorageI2C::blockSize()
+{
+  return (_twoAddress ? 0x10000 : 0x100);
+}
+
+#endif // ARDUINO
@@ -0,0 +1,199 @@
+// MIT License
+
+// Copyright (c) 2022 Gauthier Dandele
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <RFIDtoEEPROM.h>
+
+#if defined(ARDUINO)
+
+// 25xx / FM25 instruction set
+#define SPI_WREN 0x06
+#define SPI_RDSR 0x05
+#define SPI_READ 0x03
+#define SPI_WRITE 0x02
+
+// Status register: write in progress
+#define SPI_WIP 0x01
+
+/**
+ * @brief Construct a new StorageSPI::StorageSPI object.
+ *
+ * @param eepromSize EEPROM size in kbits.
+ * @param csPin Chip select pin of EEPROM.
+ * @param fram True for a FRAM (no write cycle, no page).
+ * @param spi The SPI bus used by the EEPROM.
+ */
+StorageSPI::StorageSPI(eeprom_size_t eepromSize, uint8_t csPin, bool fram, SPIClass &spi)
+{
+  _spi = &spi;
+  _csPin = csPin;
+  _fram = fram;
+  _eepromSize = eepromSize;
+  _pageSize = eepromPageSize(eepromSize);
+
+  if (eepromSize <= KBITS_4)
+    _addressBytes = 1; // A8 is carried by the instruction
+  else if (eepromSize <= KBITS_512)
+    _addressBytes = 2;
+  else
+    _addressBytes = 3;
+}
+
+/**
+ * @brief Set the SPI communication frequency.
+ *
+ * @param spiFreq SPI Frequency.
+ */
+void StorageSPI::begin(uint32_t spiFreq)
+{
+  _settings = SPISettings(spiFreq, MSBFIRST, SPI_MODE0);
+
+  pinMode(_csPin, OUTPUT);
+  digitalWrite(_csPin, HIGH);
+  _spi->begin();
+}
+
+/**
+ * @brief Read data from SPI EEPROM.
+ *
+ * @param address Departure address for reading.
+ * @param data Buffer that will be modified by reading.
+ * @param length The Number of byte to read.
+ * @return storage_status_t STORAGE_OK or the error.
+ */
+storage_status_t StorageSPI::read(uint32_t address, uint8_t *data, uint16_t length)
+{
+  storage_status_t status = waitReady(millis());
+  if (status != STORAGE_OK)
+    return (status);
+
+  _spi->beginTransaction(_settings);
+  command(SPI_READ, address);
+  for (uint16_t n = 0; n < length; n++)
+  {
+    data[n] = _spi->transfer(0);
+  }
+  digitalWrite(_csPin, HIGH);
+  _spi->endTransaction();
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Write data to SPI EEPROM.
+ *
+ * @param address Departure address for writing.
+ * @param data Data to write.
+ * @param length The Number of byte to write.
+ * @return storage_status_t STORAGE_OK or the error.
+ */
+storage_status_t StorageSPI::write(uint32_t address, const uint8_t *data, uint16_t length)
+{
+  const unsigned long start = millis();
+
+  while (length > 0)
+  {
+    uint16_t byteWrite = length;
+
+    if (!_fram)
+    {
+      uint16_t bytePage = _pageSize - (address & (_pageSize - 1));
+      byteWrite = min(bytePage, length);
+
+      storage_status_t status = waitReady(start);
+      if (status != STORAGE_OK)
+        return (status);
+    }
+
+    _spi->beginTransaction(_settings);
+    digitalWrite(_csPin, LOW);
+    _spi->transfer(SPI_WREN);
+    digitalWrite(_csPin, HIGH);
+
+    command(SPI_WRITE, address);
+    for (uint16_t n = 0; n < byteWrite; n++)
+    {
+      _spi->transfer(data[n]);
+    }
+    digitalWrite(_csPin, HIGH);
+    _spi->endTransaction();
+
+    address += byteWrite; // Increment the EEPROM address
+    data += byteWrite;    // Increment the input data pointer
+    length -= byteWrite;  // Decrement the number of bytes left to write
+  }
+
+  return (STORAGE_OK);
+}
+
+/**
+ * @brief Returns the Number of Cells in the EEPROM.
+ *
+ * @return uint32_t The Number of Cells in the EEPROM.
+ */
+uint32_t StorageSPI::length()
+{
+  return (_eepromSize * 128);
+}
+
+/**
+ * @brief Check if device is currently writing. A FRAM is never busy.
+ *
+ * @return true Busy.
+ * @return false Ready for reading/writing.
+ */
+bool StorageSPI::isBusy()
+{
+  if (_fram)
+    return (false);
+
+  _spi->beginTransaction(_settings);
+  digitalWrite(_csPin, LOW);
+  _spi->transfer(SPI_RDSR);
+  uint8_t status = _spi->transfer(0);
+  digitalWrite(_csPin, HIGH);
+  _spi->endTransaction();
+
+  return (status & SPI_WIP);
+}
+
+/**
+ * @brief Select the chip then send the instruction and the address.
+ *
+ * @param opcode Instruction to send.
+ * @param address Memory address.
+ */
+void StorageSPI::command(uint8_t opcode, uint32_t address)
+{
+  if (_addressBytes == 1 && (address & 0x100))
+    opcode |= 0x08; // A8
+
+  digitalWrite(_csPin, LOW);
+  _spi->transfer(opcode);
+  if (_addressBytes == 3)
+    _spi->transfer((uint8_t)(address >> 16));
+  if (_addressBytes >= 2)
+    _spi->transfer((uint8_t)(address >> 8));
+  _spi->transfer((uint8_t)(address & 0xFF));
+}
+
+#endif // ARDUINO
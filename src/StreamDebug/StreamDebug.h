@@ -23,7 +23,11 @@
 #ifndef StreamDebug_h
 #define StreamDebug_h
 
+#if defined(ARDUINO)
 #include <Stream.h>
+#else
+#include <Host.h>
+#endif
 
 class StreamDebug
 {